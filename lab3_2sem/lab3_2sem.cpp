@@ -1,6 +1,14 @@
 #include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <new>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -10,8 +18,13 @@ constexpr auto CHECK_INVERSE = "chkinv";
 constexpr auto CHECK_DIRECT = "chkdir";
 constexpr auto CALCULATE_INVERSE = "calcinv";
 constexpr auto CALCULATE_DIRECT = "calcdir";
+constexpr auto CALCULATE_STANDARD = "calcstd";
 constexpr auto STANDARD_TO_INVERSE = "stdtoinv";
 constexpr auto STANDARD_TO_DIRECT = "stdtodir";
+constexpr auto STANDARD_TO_BOTH = "stdtoboth";
+constexpr auto BENCHMARK = "bench";
+constexpr auto MEMORY_STATS = "memstat";
+constexpr auto TRACE = "trace";
 constexpr auto ABOUT = "about";
 constexpr auto HELP = "help";
 constexpr auto EXIT = "exit";
@@ -46,9 +59,14 @@ void helpEndpoint()
 	printCommandDescription(STANDARD_TO_DIRECT, "Convert standard math expression into direct polish notation [1+2] -> [+12]");
 	printCommandDescription(CHECK_DIRECT, "Check validity of math expression in direct polish notation [+12]");
 	printCommandDescription(CALCULATE_DIRECT, "Calculate math expression in direct polish notation [+12]");
+	printCommandDescription(CALCULATE_STANDARD, "Calculate standard math expression [1+2]");
 	printCommandDescription(STANDARD_TO_INVERSE, "Convert standard math expression into inverse polish notation [1+2] -> [12+]");
 	printCommandDescription(CHECK_INVERSE, "Check validity of math expression in inverse polish notation [12+]");
 	printCommandDescription(CALCULATE_INVERSE, "Calculate math expression in inverse polish notation [12+]");
+	printCommandDescription(STANDARD_TO_BOTH, "Convert standard math expression into both polish notations with a single parse");
+	printCommandDescription(BENCHMARK, "Compare conversion and calculation speed and allocations of the AST front end with the stack converters");
+	printCommandDescription(MEMORY_STATS, "Toggle allocation tracking. Reports allocations per pipeline stage and per command");
+	printCommandDescription(TRACE, "Toggle execution tracing. When stopped, saves the timeline as Chrome trace-event JSON");
 	printCommandDescription(ABOUT, "View info about this program");
 	printCommandDescription(EXIT, "Stop program execution");
 }
@@ -64,7 +82,8 @@ enum class loggerMode
 	debug = 1,
 	information = 2,
 	warning = 3,
-	error = 4
+	error = 4,
+	silent = 5
 };
 
 class Logger
@@ -77,6 +96,17 @@ public:
 		mode = newMode;
 	}
 
+	loggerMode getLoggerMode() const
+	{
+		return mode;
+	}
+
+	// Lets callers skip building messages that would be filtered out anyway
+	bool allows(const loggerMode level) const
+	{
+		return mode <= level;
+	}
+
 	void verbose(const std::initializer_list<const char *> messages) const
 	{
 		if (mode > loggerMode::verbose) return;
@@ -120,6 +150,317 @@ public:
 
 Logger logger;
 
+struct AllocationStats
+{
+	size_t allocations = 0;
+	size_t bytesAllocated = 0;
+	size_t liveBytes = 0;
+	size_t peakLiveBytes = 0;
+};
+
+// Counters are fed by the global operator new/delete below, which are only compiled in when
+// ENABLE_ALLOCATION_TRACKING is defined. They are then kept up to date at all times, so snapshots
+// taken at any point are consistent. Enabling the tracker only turns on the reports
+class AllocationTracker
+{
+private:
+	bool enabled = false;
+	AllocationStats stats;
+	AllocationStats sessionStart;
+public:
+	bool isEnabled() const
+	{
+		return enabled;
+	}
+
+	void enable()
+	{
+		stats.peakLiveBytes = stats.liveBytes;
+		sessionStart = stats;
+		enabled = true;
+	}
+
+	void disable()
+	{
+		enabled = false;
+	}
+
+	AllocationStats snapshot() const
+	{
+		return stats;
+	}
+
+	AllocationStats sessionSnapshot() const
+	{
+		return sessionStart;
+	}
+
+	void setPeakLiveBytes(const size_t bytes)
+	{
+		stats.peakLiveBytes = bytes;
+	}
+
+	void recordAllocation(const size_t size)
+	{
+		++stats.allocations;
+		stats.bytesAllocated += size;
+		stats.liveBytes += size;
+		if (stats.liveBytes > stats.peakLiveBytes) stats.peakLiveBytes = stats.liveBytes;
+	}
+
+	void recordDeallocation(const size_t size)
+	{
+		stats.liveBytes -= size;
+	}
+};
+
+AllocationTracker allocationTracker;
+
+#ifdef ENABLE_ALLOCATION_TRACKING
+// Every block carries its size in a header so that deallocations can be subtracted from live bytes
+constexpr size_t allocationHeaderSize = alignof(std::max_align_t);
+
+void* operator new(const size_t size)
+{
+	void* block = std::malloc(size + allocationHeaderSize);
+	if (block == nullptr) throw std::bad_alloc();
+
+	*static_cast<size_t*>(block) = size;
+	allocationTracker.recordAllocation(size);
+	return static_cast<char*>(block) + allocationHeaderSize;
+}
+
+void* operator new[](const size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	if (ptr == nullptr) return;
+
+	void* block = static_cast<char*>(ptr) - allocationHeaderSize;
+	allocationTracker.recordDeallocation(*static_cast<size_t*>(block));
+	std::free(block);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	operator delete(ptr);
+}
+#endif
+
+// Prints straight to std::cout: building the report through strings would allocate and skew enclosing scopes
+void printAllocationReport(const char* stage, const AllocationStats& start, const AllocationStats& end)
+{
+	std::cout << "\n[MEMORY] " << stage << ": "
+		<< end.allocations - start.allocations << " allocations, "
+		<< end.bytesAllocated - start.bytesAllocated << " bytes allocated, "
+		<< end.peakLiveBytes - start.liveBytes << " peak live bytes";
+}
+
+// Measures allocations made during its lifetime. Scopes may be nested:
+// the peak is rebased on entry and the outer peak is restored on exit.
+// Without ENABLE_ALLOCATION_TRACKING it compiles to nothing
+class AllocationScope
+{
+#ifdef ENABLE_ALLOCATION_TRACKING
+private:
+	const char* stage;
+	const bool active;
+	const AllocationStats start;
+public:
+	explicit AllocationScope(const char* stage)
+		: stage(stage), active(allocationTracker.isEnabled()), start(allocationTracker.snapshot())
+	{
+		allocationTracker.setPeakLiveBytes(start.liveBytes);
+	}
+
+	AllocationScope(const AllocationScope&) = delete;
+	AllocationScope& operator=(const AllocationScope&) = delete;
+
+	~AllocationScope()
+	{
+		const AllocationStats end = allocationTracker.snapshot();
+		allocationTracker.setPeakLiveBytes(std::max(start.peakLiveBytes, end.peakLiveBytes));
+
+		if (active && allocationTracker.isEnabled()) printAllocationReport(stage, start, end);
+	}
+#else
+public:
+	explicit AllocationScope(const char*)
+	{
+	}
+
+	AllocationScope(const AllocationScope&) = delete;
+	AllocationScope& operator=(const AllocationScope&) = delete;
+#endif
+};
+
+#ifndef DISABLE_TRACING
+constexpr size_t traceCapacity = 1 << 16;
+constexpr size_t traceNameLength = 32;
+
+struct TraceEvent
+{
+	// Names are copied: scopes may be named after strings that do not outlive the trace
+	char name[traceNameLength];
+	char phase;
+	long long timestamp;
+};
+
+void writeJsonString(std::ostream& out, const char* str)
+{
+	out << '"';
+	for (; *str != '\0'; ++str)
+	{
+		const unsigned char ch = *str;
+		if (ch == '"' || ch == '\\') out << '\\' << ch;
+		else if (ch < 0x20) out << ' ';
+		else out << ch;
+	}
+	out << '"';
+}
+
+// Events go into a preallocated buffer so that recording neither allocates nor skews allocation reports.
+// A slot is reserved for the end event of every open scope, so once the buffer fills up only new scopes
+// are dropped (and counted) and the exported trace always stays balanced
+class Tracer
+{
+private:
+	bool enabled = false;
+	size_t count = 0;
+	size_t openScopes = 0;
+	size_t dropped = 0;
+	std::chrono::steady_clock::time_point start;
+	TraceEvent events[traceCapacity];
+public:
+	bool isEnabled() const
+	{
+		return enabled;
+	}
+
+	size_t eventCount() const
+	{
+		return count;
+	}
+
+	size_t droppedCount() const
+	{
+		return dropped;
+	}
+
+	void enable()
+	{
+		count = 0;
+		openScopes = 0;
+		dropped = 0;
+		start = std::chrono::steady_clock::now();
+		enabled = true;
+	}
+
+	void disable()
+	{
+		enabled = false;
+	}
+
+private:
+	void record(const char* name, const char phase)
+	{
+		TraceEvent& event = events[count++];
+		size_t length = 0;
+		for (; length < traceNameLength - 1 && name[length] != '\0'; ++length) event.name[length] = name[length];
+		event.name[length] = '\0';
+		event.phase = phase;
+		event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	}
+
+public:
+	bool begin(const char* name)
+	{
+		if (count + openScopes + 2 > traceCapacity)
+		{
+			++dropped;
+			return false;
+		}
+
+		++openScopes;
+		record(name, 'B');
+		return true;
+	}
+
+	void end(const char* name)
+	{
+		--openScopes;
+		record(name, 'E');
+	}
+
+	bool exportChromeTrace(const std::string& path) const
+	{
+		std::ofstream out(path);
+		if (!out) return false;
+
+		out << "{\"traceEvents\":[";
+		for (size_t i = 0; i < count; ++i)
+		{
+			const TraceEvent& event = events[i];
+			if (i != 0) out << ",";
+			out << "\n{\"name\":";
+			writeJsonString(out, event.name);
+			out << ",\"cat\":\"pipeline\",\"ph\":\"" << event.phase
+				<< "\",\"ts\":" << event.timestamp / 1000 << "." << event.timestamp % 1000 / 100
+				<< ",\"pid\":1,\"tid\":1}";
+		}
+		out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		return static_cast<bool>(out);
+	}
+};
+
+Tracer tracer;
+
+// Records begin/end events around its lifetime. While tracing is off this costs a single branch;
+// with DISABLE_TRACING defined it compiles to nothing
+class TraceScope
+{
+private:
+	const char* name;
+	const bool active;
+public:
+	explicit TraceScope(const char* name) : name(name), active(tracer.isEnabled() && tracer.begin(name))
+	{
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+	~TraceScope()
+	{
+		if (active && tracer.isEnabled()) tracer.end(name);
+	}
+};
+#else
+class TraceScope
+{
+public:
+	explicit TraceScope(const char*)
+	{
+	}
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+};
+#endif
+
 template <typename T>
 struct Result
 {
@@ -131,7 +472,7 @@ public:
 	static Result<T> error(std::vector<std::string> err)
 	{
 		Result<T> res;
-		res.errors = err;
+		res.errors = std::move(err);
 		res.isSuccess = false;
 		return res;
 	}
@@ -139,7 +480,7 @@ public:
 	static Result<T> success(T val)
 	{
 		Result<T> res;
-		res.res = val;
+		res.res = std::move(val);
 		res.isSuccess = true;
 		return res;
 	}
@@ -253,6 +594,8 @@ std::string viewTokens(const std::vector<std::string>& tokens)
 
 std::vector<std::string> tokenize(const std::string& str)
 {
+	const AllocationScope allocationScope("tokenize");
+	const TraceScope traceScope("tokenize");
 	logger.verbose({"Tokenization started. Received string: ", str.c_str()});
 	std::vector<std::string> res;
 	bool foundForeignSymbol = true;
@@ -272,6 +615,8 @@ std::vector<std::string> tokenize(const std::string& str)
 
 void replaceVariables(std::vector<std::string>& tokens)
 {
+	const AllocationScope allocationScope("replaceVariables");
+	const TraceScope traceScope("replaceVariables");
 	logger.verbose({"Variable replacement started. Received tokens: ", viewTokens(tokens).c_str()});
 	for (int i = 0; i < tokens.size(); ++i)
 	{
@@ -309,6 +654,8 @@ void replaceVariables(std::vector<std::string>& tokens)
 
 Result<int> calculateDirect(const std::vector<std::string>& tokens)
 {
+	const AllocationScope allocationScope("calculateDirect");
+	const TraceScope traceScope("calculateDirect");
 	Stack<int> stack;
 	for (int i = tokens.size() - 1; i >= 0; --i)
 	{
@@ -331,7 +678,7 @@ Result<int> calculateDirect(const std::vector<std::string>& tokens)
 				const std::string val1String = std::to_string(val1);
 				stack.pop();
 
-				int res;
+				int res = 0;
 
 				if (token == "+") res = val1 + val2;
 				if (token == "-") res = val1 - val2;
@@ -356,7 +703,7 @@ Result<int> calculateDirect(const std::vector<std::string>& tokens)
 			return Result<int>::error({ errorMessage });
 		}
 		logger.debug({ "Encountered token: ", token.c_str() });
-		logger.debug({ "Current stack: ", stack.toString().c_str() });
+		if (logger.allows(loggerMode::debug)) logger.debug({ "Current stack: ", stack.toString().c_str() });
 	}
 	if (stack.empty())
 	{
@@ -378,6 +725,8 @@ Result<int> calculateDirect(const std::vector<std::string>& tokens)
 
 Result<int> calculateInverse(const std::vector<std::string>& tokens, const bool ignoreVariables = false)
 {
+	const AllocationScope allocationScope("calculateInverse");
+	const TraceScope traceScope("calculateInverse");
 	Stack<int> stack;
 	for(const std::string& token : tokens)
 	{
@@ -396,7 +745,7 @@ Result<int> calculateInverse(const std::vector<std::string>& tokens, const bool
 				const std::string val1String = std::to_string(val1);
 				stack.pop();
 
-				int res;
+				int res = 0;
 
 				if (token == "+") res = val1 + val2;
 				if (token == "-") res = val1 - val2;
@@ -419,7 +768,7 @@ Result<int> calculateInverse(const std::vector<std::string>& tokens, const bool
 			return Result<int>::error({ errorMessage });
 		}
 		logger.debug({ "Token: ", token.c_str() });
-		logger.debug({ "Stack: ", stack.toString().c_str() });
+		if (logger.allows(loggerMode::debug)) logger.debug({ "Stack: ", stack.toString().c_str() });
 	}
 	if(stack.empty())
 	{
@@ -439,9 +788,9 @@ Result<int> calculateInverse(const std::vector<std::string>& tokens, const bool
 	return Result<int>::success(res);
 }
 
-void printErrorMessage(std::vector<std::string> messages)
+void printErrorMessage(std::vector<std::string> messages, const char* title = "Could not calculate direct polish notation.")
 {
-	std::cout << "\n\nCould not calculate direct polish notation.";
+	std::cout << "\n\n" << title;
 	std::cout << "\nErrors: ";
 	for(int i = 0; i < messages.size(); ++i)
 		std::cout << "\n" << i + 1 << ") " << messages[i];
@@ -506,8 +855,279 @@ void calculateInverseEndpoint()
 	else printErrorMessage(res.errors);
 }
 
+enum class astNodeKind
+{
+	number = 0,
+	variable = 1,
+	operation = 2
+};
+
+struct AstNode
+{
+	astNodeKind kind;
+	int offset;
+	int length;
+	int left;
+	int right;
+};
+
+// Expression tree stored in a single arena. Nodes are linked by index and are appended in postfix order
+// (operands before the operation that consumes them), so the arena itself is the inverse polish notation
+// and walking it backwards gives the direct polish notation in the operand order calculateDirect expects.
+// Node symbols are copied once into a single buffer, laid out as the inverse polish notation text
+class Ast
+{
+private:
+	std::string symbols;
+	std::vector<AstNode> nodes;
+
+	void write(std::string& out, const bool reversed) const
+	{
+		if (!reversed)
+		{
+			out.assign(symbols);
+			return;
+		}
+
+		out.resize(symbols.size());
+		char* cursor = &out[0];
+		for (size_t i = nodes.size(); i-- > 0;)
+		{
+			const AstNode& node = nodes[i];
+			if (i != nodes.size() - 1) *cursor++ = ' ';
+			cursor = std::copy_n(symbols.data() + node.offset, node.length, cursor);
+		}
+	}
+
+	void append(const astNodeKind kind, const std::string& token, const int left, const int right)
+	{
+		if (!nodes.empty()) symbols += ' ';
+
+		AstNode node;
+		node.kind = kind;
+		node.offset = static_cast<int>(symbols.size());
+		node.length = static_cast<int>(token.size());
+		node.left = left;
+		node.right = right;
+
+		symbols += token;
+		nodes.push_back(node);
+	}
+
+	static bool reduce(Ast& ast, std::vector<int>& operands, const std::string& op)
+	{
+		if (operands.size() < 2) return false;
+
+		const int right = operands.back();
+		operands.pop_back();
+		const int left = operands.back();
+		operands.pop_back();
+
+		operands.push_back(static_cast<int>(ast.nodes.size()));
+		ast.append(astNodeKind::operation, op, left, right);
+		return true;
+	}
+
+	static Result<Ast> parseError(const std::string& errorMessage)
+	{
+		logger.error({ errorMessage.c_str() });
+		return Result<Ast>::error({ errorMessage });
+	}
+
+	static void logParseState(const std::vector<std::string>& tokens, const std::vector<int>& opStack, const Ast& ast)
+	{
+		if (!logger.allows(loggerMode::debug)) return;
+
+		std::string opStackString;
+		for (size_t i = opStack.size(); i-- > 0;)
+		{
+			if (i != opStack.size() - 1) opStackString += ' ';
+			opStackString += tokens[opStack[i]];
+		}
+		logger.debug({ "Operation stack: ", opStackString.c_str() });
+		logger.debug({ "Resulting expression: ", ast.symbols.c_str() });
+	}
+
+	static void logStackOperatorPop(const std::string& stackOp, const std::string& op, const int opWeight)
+	{
+		if (!logger.allows(loggerMode::information)) return;
+
+		const std::string stackOpWeightStr = std::to_string(operatorWeight(stackOp));
+		const std::string opWeightStr = std::to_string(opWeight);
+		logger.information({"Stack operator[", stackOp.c_str(), "] weight(", stackOpWeightStr.c_str(),
+			") >= found operator[", op.c_str(), "] weight(", opWeightStr.c_str(),
+			"). Pushing ", stackOp.c_str(), " to resulting expression."});
+	}
+
+public:
+	static Result<Ast> parse(const std::vector<std::string>& tokens)
+	{
+		const AllocationScope allocationScope("Ast::parse");
+		const TraceScope traceScope("Ast::parse");
+		logger.verbose({"Parsing of standard notation started"});
+
+		size_t symbolsLength = 0;
+		for (const std::string& token : tokens) symbolsLength += token.size() + 1;
+
+		Ast ast;
+		ast.symbols.reserve(symbolsLength);
+		ast.nodes.reserve(tokens.size());
+
+		std::vector<int> operands;
+		std::vector<int> opStack;
+		operands.reserve(tokens.size());
+		opStack.reserve(tokens.size());
+
+		for (int i = 0; i < static_cast<int>(tokens.size()); ++i)
+		{
+			const std::string& token = tokens[i];
+			if (token.empty() || std::isspace(static_cast<unsigned char>(token[0]))) continue;
+
+			const int opWeight = operatorWeight(token);
+			if (token == "(")
+			{
+				logger.information({ "Found opening bracket. Pushing to operation stack" });
+				opStack.push_back(i);
+			}
+			else if (token == ")")
+			{
+				logger.information({ "Found closing bracket. Pushing operation stack to resulting expression until opening bracket is found" });
+				while (!opStack.empty() && tokens[opStack.back()] != "(")
+				{
+					if (!reduce(ast, operands, tokens[opStack.back()])) return parseError("Not enough operands in expression");
+					opStack.pop_back();
+				}
+				if (opStack.empty()) return parseError("Opening bracket not found");
+				opStack.pop_back();
+			}
+			else if (opWeight > 0)
+			{
+				std::string opWeightStr;
+				if (logger.allows(loggerMode::information))
+				{
+					opWeightStr = std::to_string(opWeight);
+					logger.information({"Found operator ", token.c_str(), " with weight ", opWeightStr.c_str()});
+				}
+
+				while (!opStack.empty() && operatorWeight(tokens[opStack.back()]) >= opWeight)
+				{
+					const std::string& stackOp = tokens[opStack.back()];
+					logStackOperatorPop(stackOp, token, opWeight);
+					if (!reduce(ast, operands, stackOp)) return parseError("Not enough operands in expression");
+					opStack.pop_back();
+				}
+
+				if (logger.allows(loggerMode::information))
+					logger.information({"Pushing operator ", token.c_str(), " with weight ", opWeightStr.c_str(), " into operation stack"});
+				opStack.push_back(i);
+			}
+			else if (isInteger(token) || std::isalpha(static_cast<unsigned char>(token[0])))
+			{
+				logger.information({"Found number/variable(", token.c_str(), "). Pushing to resulting expression"});
+				operands.push_back(static_cast<int>(ast.nodes.size()));
+				ast.append(isInteger(token) ? astNodeKind::number : astNodeKind::variable, token, -1, -1);
+			}
+			else return parseError(std::string("Received unexpected token: ") + token);
+
+			logParseState(tokens, opStack, ast);
+		}
+		logger.information({"Pushing everything from operation stack into resulting expression"});
+		while (!opStack.empty())
+		{
+			if (tokens[opStack.back()] == "(") return parseError("Closing bracket not found");
+			if (!reduce(ast, operands, tokens[opStack.back()])) return parseError("Not enough operands in expression");
+			opStack.pop_back();
+		}
+		logParseState(tokens, opStack, ast);
+
+		if (operands.empty()) return parseError("Not enough operands in expression");
+		if (operands.size() > 1) return parseError("Not enough operators in expression");
+
+		logger.verbose({"Parsing of standard notation is completed"});
+		return Result<Ast>::success(std::move(ast));
+	}
+
+	size_t size() const
+	{
+		return nodes.size();
+	}
+
+	// Both writers size the output exactly once, so reusing the same string across calls does not allocate
+	void writeDirect(std::string& out) const
+	{
+		write(out, true);
+	}
+
+	void writeInverse(std::string& out) const
+	{
+		write(out, false);
+	}
+
+	std::string toDirect() const
+	{
+		std::string out;
+		writeDirect(out);
+		return out;
+	}
+
+	std::string toInverse() const
+	{
+		std::string out;
+		writeInverse(out);
+		return out;
+	}
+
+	// Numbers are only parsed here: converting between notations never needs their values
+	Result<int> calculate() const
+	{
+		const AllocationScope allocationScope("Ast::calculate");
+		const TraceScope traceScope("Ast::calculate");
+
+		if (nodes.empty()) return Result<int>::error({ "Not enough operands in expression" });
+
+		std::vector<int> values(nodes.size());
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			const AstNode& node = nodes[i];
+			const char* symbol = symbols.data() + node.offset;
+			if (node.kind == astNodeKind::number)
+			{
+				errno = 0;
+				const long value = strtol(symbol, nullptr, 10);
+				if (errno == ERANGE || value < INT_MIN || value > INT_MAX)
+				{
+					const std::string errorMessage = std::string("Number is out of range: ") + std::string(symbol, node.length);
+					logger.error({ errorMessage.c_str() });
+					return Result<int>::error({ errorMessage });
+				}
+				values[i] = static_cast<int>(value);
+				continue;
+			}
+			if (node.kind == astNodeKind::variable)
+			{
+				const std::string errorMessage = std::string("Received unexpected token: ") + std::string(symbol, node.length);
+				logger.error({ errorMessage.c_str() });
+				return Result<int>::error({ errorMessage });
+			}
+
+			const int val1 = values[node.left];
+			const int val2 = values[node.right];
+			if (*symbol == '+') values[i] = val1 + val2;
+			if (*symbol == '-') values[i] = val1 - val2;
+			if (*symbol == '*') values[i] = val1 * val2;
+			if (*symbol == '/') {
+				if (val2 != 0) values[i] = val1 / val2;
+				else return Result<int>::error({ "Encountered division by zero" });
+			}
+		}
+		return Result<int>::success(values.back());
+	}
+};
+
 std::string convertStandardToDirect(const std::vector<std::string>& tokens)
 {
+	const AllocationScope allocationScope("convertStandardToDirect");
+	const TraceScope traceScope("convertStandardToDirect");
 	Stack<std::string> resStack;
 	Stack<std::string> opStack;
 
@@ -564,8 +1184,8 @@ std::string convertStandardToDirect(const std::vector<std::string>& tokens)
 			logger.information({"Pushing operator ", tokenStr, " with weight ", opWeightStr, " into operation stack"});
 			opStack.push(token);
 		}
-		logger.debug({ "Operation stack: ", opStack.toString().c_str() });
-		logger.debug({ "Resulting stack: ", resStack.toString().c_str() });
+		if (logger.allows(loggerMode::debug)) logger.debug({ "Operation stack: ", opStack.toString().c_str() });
+		if (logger.allows(loggerMode::debug)) logger.debug({ "Resulting stack: ", resStack.toString().c_str() });
 	}
 	logger.information({"Pushing everything from stack into resulting expression"});
 	while(!opStack.empty())
@@ -573,8 +1193,8 @@ std::string convertStandardToDirect(const std::vector<std::string>& tokens)
 		resStack.push(opStack.top());
 		opStack.pop();
 	}
-	logger.debug({ "Operation stack: ", opStack.toString().c_str() });
-	logger.debug({ "Resulting stack: ", resStack.toString().c_str() });
+	if (logger.allows(loggerMode::debug)) logger.debug({ "Operation stack: ", opStack.toString().c_str() });
+	if (logger.allows(loggerMode::debug)) logger.debug({ "Resulting stack: ", resStack.toString().c_str() });
 
 	const auto res = resStack.toString();
 
@@ -588,13 +1208,16 @@ void standardToDirectEndpoint()
 	askFor("standard expression to convert to direct polish notation");
 	std::getline(std::cin, expr);
 	
-	const std::vector<std::string> tokens = tokenize(expr);
+	const Result<Ast> ast = Ast::parse(tokenize(expr));
 
-	std::cout << "\n\nResulting expression: " << convertStandardToDirect(tokens);
+	if (ast.isSuccess) std::cout << "\n\nResulting expression: " << ast.res.toDirect();
+	else printErrorMessage(ast.errors, "Could not convert expression to direct polish notation.");
 }
 
 std::string convertStandardToInverse(const std::vector<std::string>& tokens)
 {
+	const AllocationScope allocationScope("convertStandardToInverse");
+	const TraceScope traceScope("convertStandardToInverse");
 	std::string expr;
 	Stack<std::string> stack;
 	logger.verbose({"Conversion [standard notation -> inverse polish notation] started"});
@@ -652,7 +1275,7 @@ std::string convertStandardToInverse(const std::vector<std::string>& tokens)
 		}
 
 		logger.debug({"Resulting string: ", expr.c_str()});
-		logger.debug({"Stack: ", stack.toString().c_str()});
+		if (logger.allows(loggerMode::debug)) logger.debug({"Stack: ", stack.toString().c_str()});
 	}
 	logger.information({"Pushing everything from stack into resulting expression"});
 	while(!stack.empty())
@@ -661,7 +1284,7 @@ std::string convertStandardToInverse(const std::vector<std::string>& tokens)
 		stack.pop();
 	}
 	logger.debug({"Resulting string: ", expr.c_str()});
-	logger.debug({"Stack: ", stack.toString().c_str()});
+	if (logger.allows(loggerMode::debug)) logger.debug({"Stack: ", stack.toString().c_str()});
 	logger.verbose({"Conversion [standard notation -> inverse polish notation] is completed"});
 
 	return expr;
@@ -673,19 +1296,241 @@ void standardToInverseEndpoint()
 	askFor("standard expression to convert to inverse polish notation");
 	std::getline(std::cin, str);
 
-	const std::vector<std::string> tokens = tokenize(str);
+	const Result<Ast> ast = Ast::parse(tokenize(str));
 
-	std::cout << "\n\nResulting expression: " << convertStandardToInverse(tokens);
+	if (ast.isSuccess) std::cout << "\n\nResulting expression: " << ast.res.toInverse();
+	else printErrorMessage(ast.errors, "Could not convert expression to inverse polish notation.");
+}
+
+void standardToBothEndpoint()
+{
+	std::string str;
+	askFor("standard expression to convert to direct and inverse polish notations");
+	std::getline(std::cin, str);
+
+	const Result<Ast> ast = Ast::parse(tokenize(str));
+
+	if (!ast.isSuccess) return printErrorMessage(ast.errors, "Could not convert expression to polish notations.");
+	std::cout << "\n\nDirect polish notation: " << ast.res.toDirect();
+	std::cout << "\nInverse polish notation: " << ast.res.toInverse();
+}
+
+void calculateStandardEndpoint()
+{
+	std::string str;
+	askFor("standard expression to calculate");
+	std::getline(std::cin, str);
+
+	std::vector<std::string> tokens = tokenize(str);
+	replaceVariables(tokens);
+
+	const Result<Ast> ast = Ast::parse(tokens);
+	if (!ast.isSuccess) return printErrorMessage(ast.errors, "Could not calculate standard expression.");
+
+	const Result<int> res = ast.res.calculate();
+
+	if (res.isSuccess) std::cout << "\n\nResult: " << res.res;
+	else printErrorMessage(res.errors, "Could not calculate standard expression.");
+}
+
+std::string generateBenchmarkExpression(const int groups)
+{
+	std::string expr;
+	for (int i = 0; i < groups; ++i)
+	{
+		if (i != 0) expr += " + ";
+		expr += "( " + std::to_string(i % 97 + 1) + " + " + std::to_string(i % 89 + 1) + " ) * "
+			+ std::to_string(i % 7 + 1) + " - " + std::to_string(i % 83 + 1) + " / " + std::to_string(i % 5 + 1);
+	}
+	return expr;
+}
+
+struct ConversionCase
+{
+	const char* expr;
+	const char* direct;
+	const char* inverse;
+	bool calculable;
+};
+
+// Inputs that once broke the converters. Checked before every benchmark so the timings are never taken on wrong output
+bool checkConversionRegressions()
+{
+	const ConversionCase cases[] = {
+		{ "4 - 1", "- 1 4", "4 1 -", true },
+		{ "( 1 + 2 ) * 3", "* 3 + 2 1", "1 2 + 3 *", true },
+		{ "99999999999 + 1", "+ 1 99999999999", "99999999999 1 +", false },
+	};
+
+	bool passed = true;
+	for (const ConversionCase& conversionCase : cases)
+	{
+		const Result<Ast> ast = Ast::parse(tokenize(conversionCase.expr));
+		const bool converted = ast.isSuccess
+			&& ast.res.toDirect() == conversionCase.direct
+			&& ast.res.toInverse() == conversionCase.inverse
+			&& ast.res.calculate().isSuccess == conversionCase.calculable;
+		if (!converted) std::cout << "\nRegression check failed: [" << conversionCase.expr << "]";
+		passed = passed && converted;
+	}
+	return passed;
+}
+
+void printBenchmarkLine(const char* name, const size_t tokenCount, const int repetitions,
+	const std::chrono::steady_clock::duration elapsed, [[maybe_unused]] const AllocationStats& start, [[maybe_unused]] const AllocationStats& end)
+{
+	std::cout << "\n" << name << " [" << tokenCount << " tokens]: "
+		<< std::chrono::duration<double, std::micro>(elapsed).count() / repetitions << " us";
+#ifdef ENABLE_ALLOCATION_TRACKING
+	std::cout << ", " << (end.allocations - start.allocations) / repetitions << " allocations, "
+		<< (end.bytesAllocated - start.bytesAllocated) / repetitions << " bytes allocated per run, "
+		<< end.peakLiveBytes - start.liveBytes << " peak live bytes";
+#endif
+}
+
+template <typename F>
+void runBenchmark(const char* name, const size_t tokenCount, const int repetitions, F body)
+{
+	const AllocationStats start = allocationTracker.snapshot();
+	allocationTracker.setPeakLiveBytes(start.liveBytes);
+
+	const auto startTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < repetitions; ++i) body();
+	const auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+	const AllocationStats end = allocationTracker.snapshot();
+	allocationTracker.setPeakLiveBytes(std::max(start.peakLiveBytes, end.peakLiveBytes));
+	printBenchmarkLine(name, tokenCount, repetitions, elapsed, start, end);
+}
+
+void benchmarkEndpoint()
+{
+	const loggerMode previousMode = logger.getLoggerMode();
+
+	// Some regression cases are expected to fail, so their error messages are not shown
+	logger.setLoggerMode(loggerMode::silent);
+	const bool regressionsPassed = checkConversionRegressions();
+	logger.setLoggerMode(loggerMode::error);
+
+	constexpr int repetitions = 3;
+	for (const int groups : { 100, 1000, 4000 })
+	{
+		if (!regressionsPassed) break;
+
+		const std::vector<std::string> tokens = tokenize(generateBenchmarkExpression(groups));
+		const size_t tokenCount = tokens.size();
+		std::string direct;
+		std::string inverse;
+
+		const Result<Ast> ast = Ast::parse(tokens);
+		if (!ast.isSuccess)
+		{
+			printErrorMessage(ast.errors, "Could not parse benchmark expression.");
+			break;
+		}
+
+		std::cout << "\n";
+		runBenchmark("stack converters, both notations", tokenCount, repetitions, [&]
+		{
+			direct = convertStandardToDirect(tokens);
+			inverse = convertStandardToInverse(tokens);
+		});
+		runBenchmark("AST, both notations", tokenCount, repetitions, [&]
+		{
+			const Result<Ast> parsed = Ast::parse(tokens);
+			parsed.res.writeDirect(direct);
+			parsed.res.writeInverse(inverse);
+		});
+
+		ast.res.writeInverse(inverse);
+		const std::vector<std::string> inverseTokens = tokenize(inverse);
+		runBenchmark("calculateInverse on converted tokens", inverseTokens.size(), repetitions, [&]
+		{
+			calculateInverse(inverseTokens);
+		});
+		runBenchmark("Ast::calculate", ast.res.size(), repetitions, [&]
+		{
+			ast.res.calculate();
+		});
+	}
+
+	logger.setLoggerMode(previousMode);
+}
+
+void memoryStatsEndpoint()
+{
+#ifndef ENABLE_ALLOCATION_TRACKING
+	std::cout << "\nAllocation tracking is not compiled in (define ENABLE_ALLOCATION_TRACKING to build it)";
+#else
+	if (!allocationTracker.isEnabled())
+	{
+		allocationTracker.enable();
+		std::cout << "\nAllocation tracking enabled";
+		return;
+	}
+
+	printAllocationReport("session", allocationTracker.sessionSnapshot(), allocationTracker.snapshot());
+	allocationTracker.disable();
+	std::cout << "\nAllocation tracking disabled";
+#endif
+}
+
+void traceEndpoint()
+{
+#ifdef DISABLE_TRACING
+	std::cout << "\nTracing is not compiled in (DISABLE_TRACING is defined)";
+#else
+	if (!tracer.isEnabled())
+	{
+		tracer.enable();
+		std::cout << "\nTracing enabled";
+		return;
+	}
+
+	tracer.disable();
+
+	std::string path;
+	askFor("file to save trace to");
+	// The buffer is only reset by the next enable(), so a failed save can be retried with another path
+	bool saved = false;
+	while (std::getline(std::cin, path) && !path.empty())
+	{
+		saved = tracer.exportChromeTrace(path);
+		if (saved) break;
+
+		std::cout << "\nCould not write trace to " << path;
+		askFor("another file to save trace to (leave empty to discard the trace)");
+	}
+
+	if (!saved)
+	{
+		std::cout << "\nTrace discarded";
+		return;
+	}
+
+	std::cout << "\nSaved " << tracer.eventCount() << " events to " << path;
+	if (tracer.droppedCount() > 0) std::cout << " (" << tracer.droppedCount() << " scopes dropped: trace buffer is full)";
+#endif
 }
 
 void processEndpoint(const char* endpoint)
 {
+	if (strcmp(endpoint, MEMORY_STATS) == 0) return memoryStatsEndpoint();
+
+	if (strcmp(endpoint, TRACE) == 0) return traceEndpoint();
+
+	const AllocationScope allocationScope(endpoint);
+	const TraceScope traceScope(endpoint);
+
 	if (strcmp(endpoint, CHECK_DIRECT) == 0) return checkDirectEndpoint();
 	if (strcmp(endpoint, CHECK_INVERSE) == 0) return checkInverseEndpoint();
 	if (strcmp(endpoint, CALCULATE_DIRECT) == 0) return calculateDirectEndpoint();
+	if (strcmp(endpoint, CALCULATE_STANDARD) == 0) return calculateStandardEndpoint();
 	if (strcmp(endpoint, CALCULATE_INVERSE) == 0) return calculateInverseEndpoint();
 	if (strcmp(endpoint, STANDARD_TO_DIRECT) == 0) return standardToDirectEndpoint();
 	if (strcmp(endpoint, STANDARD_TO_INVERSE) == 0) return standardToInverseEndpoint();
+	if (strcmp(endpoint, STANDARD_TO_BOTH) == 0) return standardToBothEndpoint();
+	if (strcmp(endpoint, BENCHMARK) == 0) return benchmarkEndpoint();
 	if (strcmp(endpoint, HELP) == 0) return helpEndpoint();
 	if (strcmp(endpoint, ABOUT) == 0) return infoEndpoint();
 	if (strcmp(endpoint, EXIT) == 0) return exitEndpoint();